@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""Compare two run_benchmark.py result files and flag regressions.
+
+Runs are grouped per instance and reduced to the median over repeats.
+An instance is flagged when
+  - the solution sizes differ (both runs finished),
+  - the baseline finished but the candidate did not,
+  - a run finished without a parsable solution size (status "noparse",
+    usually a --size-re that does not match the solver's output),
+  - median time, node count or peak RSS grew by more than the given
+    ratio (time is only compared above --min-ms, to ignore noise).
+
+Time is the solver's own reported time when both files have it for an
+instance, and the harness's wall time otherwise (--time wall forces
+it). Node counts are not compared for instances whose baseline repeats
+disagree, as threaded variants explore a different tree on every run.
+
+Exit status is 1 when anything is flagged, 0 otherwise.
+
+Example:
+    ./compare.py baseline.json candidate.json --time-ratio 1.10
+"""
+
+import argparse
+import csv
+import json
+import statistics
+import sys
+
+
+def load(path):
+    if path.endswith('.json'):
+        with open(path) as f:
+            return json.load(f)['runs']
+    with open(path, newline='') as f:
+        rows = list(csv.DictReader(f))
+    for row in rows:
+        for key in ('wall_ms', 'solver_ms'):
+            row[key] = float(row[key]) if row[key] else None
+        for key in ('nodes', 'size', 'peak_rss_kb'):
+            row[key] = int(row[key]) if row[key] else None
+    return rows
+
+
+def median(values):
+    values = [v for v in values if v is not None]
+    return statistics.median(values) if values else None
+
+
+def summarise(rows):
+    groups = {}
+    for row in rows:
+        groups.setdefault(row['instance'], []).append(row)
+    summary = {}
+    for name, runs in groups.items():
+        ok = [r for r in runs if r['status'] == 'ok']
+        sizes = {r['size'] for r in ok if r['size'] is not None}
+        unparsed = sum(1 for r in runs if r['status'] == 'noparse'
+                       or (r['status'] == 'ok' and r['size'] is None))
+        summary[name] = {
+            'solved': bool(sizes),
+            'sizes': sizes,
+            'unparsed': unparsed,
+            'wall_ms': median(r['wall_ms'] for r in ok),
+            'solver_ms': median(r['solver_ms'] for r in ok),
+            'nodes': median(r['nodes'] for r in ok),
+            'nodes_stable': len({r['nodes'] for r in ok}) <= 1,
+            'peak_rss_kb': median(r['peak_rss_kb'] for r in ok),
+        }
+    return summary
+
+
+def grew(old, new, ratio):
+    return old is not None and new is not None and old > 0 and new > old * ratio
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('baseline')
+    parser.add_argument('candidate')
+    parser.add_argument('--time-ratio', type=float, default=1.10)
+    parser.add_argument('--time', choices=['auto', 'wall'], default='auto',
+                        help='auto: solver-reported time when available')
+    parser.add_argument('--nodes-ratio', type=float, default=1.05)
+    parser.add_argument('--rss-ratio', type=float, default=1.20)
+    parser.add_argument('--min-ms', type=float, default=50.0,
+                        help='ignore time changes when both medians are below this')
+    args = parser.parse_args()
+
+    base = summarise(load(args.baseline))
+    cand = summarise(load(args.candidate))
+
+    flagged = 0
+    compared = 0
+    for name in sorted(base):
+        if name not in cand:
+            continue
+        compared += 1
+        b, c = base[name], cand[name]
+        problems = []
+        for label, s in (('baseline', b), ('candidate', c)):
+            if s['unparsed']:
+                problems.append('%d %s run(s) without a parsed size' % (s['unparsed'], label))
+        if b['solved'] and not c['solved']:
+            problems.append('no longer solved')
+        if len(b['sizes']) > 1 or len(c['sizes']) > 1:
+            problems.append('inconsistent sizes across repeats')
+        if b['solved'] and c['solved'] and b['sizes'] != c['sizes']:
+            problems.append('size %s -> %s' % (sorted(b['sizes']), sorted(c['sizes'])))
+        key = 'wall_ms'
+        if (args.time == 'auto' and b['solver_ms'] is not None
+                and c['solver_ms'] is not None):
+            key = 'solver_ms'
+        if (grew(b[key], c[key], args.time_ratio)
+                and max(b[key], c[key]) >= args.min_ms):
+            problems.append('%s %.1f -> %.1f ms' % (key[:-3], b[key], c[key]))
+        if b['nodes_stable'] and grew(b['nodes'], c['nodes'], args.nodes_ratio):
+            problems.append('nodes %d -> %d' % (b['nodes'], c['nodes']))
+        if grew(b['peak_rss_kb'], c['peak_rss_kb'], args.rss_ratio):
+            problems.append('rss %d -> %d kB' % (b['peak_rss_kb'], c['peak_rss_kb']))
+        if problems:
+            flagged += 1
+            print('%-40s %s' % (name, '; '.join(problems)))
+
+    missing = sorted(set(base) ^ set(cand))
+    if missing:
+        print('%d instance(s) present in only one file' % len(missing), file=sys.stderr)
+    print('%d of %d instance(s) flagged' % (flagged, compared))
+    return 1 if flagged else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
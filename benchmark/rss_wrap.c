@@ -0,0 +1,56 @@
+/*
+ * rss_wrap FD COMMAND [ARG...]
+ *
+ * Runs COMMAND in a child and writes the child's peak RSS in kilobytes to
+ * file descriptor FD when it exits, then exits with the child's status.
+ *
+ * The Linux ru_maxrss of a process includes the memory of whatever forked
+ * it before exec, so measuring the solver directly from the Python harness
+ * reports at least the harness's own size. Forking from this small process
+ * keeps that floor down to a few hundred kilobytes.
+ *
+ * Build: cc -O2 -o rss_wrap rss_wrap.c
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s FD COMMAND [ARG...]\n", argv[0]);
+        return 127;
+    }
+    int fd = atoi(argv[1]);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return 127;
+    }
+    if (pid == 0) {
+        close(fd);
+        execvp(argv[2], argv + 2);
+        perror(argv[2]);
+        _exit(127);
+    }
+
+    int status;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) < 0) {
+        perror("wait4");
+        return 127;
+    }
+    dprintf(fd, "%ld\n", usage.ru_maxrss);
+    close(fd);
+
+    if (WIFSIGNALED(status)) {
+        signal(WTERMSIG(status), SIG_DFL);
+        raise(WTERMSIG(status));
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 127;
+}
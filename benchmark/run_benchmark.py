@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+"""Run a McSplit variant over a subset of the ARG Database.
+
+Instances are discovered by globbing FAMILY patterns below the database
+root. Files that share a stem and a numeric id (e.g. mcs10_r01_s10.A00 and
+mcs10_r01_s10.B00) form one instance; every file of an instance is passed
+to the solver in letter order.
+
+The solver command is a template: "{graphs}" is replaced by the instance
+files, "{timeout}" by the per-instance timeout in seconds. Each run is
+killed when the timeout expires. Solution size, node count and the
+solver's own time are parsed from stdout with configurable regexes; a
+run that exits cleanly without a parsable size is recorded as "noparse".
+Wall time and peak RSS are measured by the harness, the latter through
+the rss_wrap helper, which is compiled with $CC (default cc) on first use.
+
+Example:
+    ./run_benchmark.py --root ~/arg --family 'mcs10/*r01*' \\
+        --cmd '../MultiGraph/mcsplit -l {graphs}' --repeat 3 \\
+        --timeout 60 --csv multigraph.csv --json multigraph.json
+"""
+
+import argparse
+import csv
+import glob
+import json
+import math
+import os
+import re
+import shlex
+import shutil
+import signal
+import subprocess
+import sys
+import threading
+import time
+
+INSTANCE_RE = re.compile(r'^(?P<stem>.+)\.(?P<graph>[A-Z]+)(?P<id>\d+)$')
+
+DEFAULT_SIZE_RE = r'[Ss]olution size\D*(\d+)'
+DEFAULT_NODES_RE = r'Nodes\D*(\d+)'
+DEFAULT_TIME_RE = r'time \(ms\)\D*([\d.]+)'
+
+RSS_SANITY_KB = 8192
+
+FIELDS = ['variant', 'family', 'instance', 'graphs', 'repeat', 'status',
+          'wall_ms', 'solver_ms', 'nodes', 'size', 'peak_rss_kb']
+
+
+def graph_order(letters):
+    return (len(letters), letters)
+
+
+def discover(root, families, limit):
+    """Return a list of (family, instance name, [graph files])."""
+    found = []
+    for family in families:
+        groups = {}
+        for path in sorted(glob.glob(os.path.join(root, family))):
+            if not os.path.isfile(path):
+                continue
+            m = INSTANCE_RE.match(os.path.basename(path))
+            if m is None:
+                continue
+            key = (os.path.dirname(path), m.group('stem'), m.group('id'))
+            groups.setdefault(key, []).append((m.group('graph'), path))
+        instances = []
+        for (dirname, stem, ident), members in sorted(groups.items()):
+            if len(members) < 2:
+                continue
+            members.sort(key=lambda item: graph_order(item[0]))
+            name = os.path.relpath(os.path.join(dirname, stem + '.' + ident), root)
+            instances.append((family, name, [p for _, p in members]))
+        if limit:
+            instances = instances[:limit]
+        found.extend(instances)
+    return found
+
+
+def parse_int(pattern, text):
+    m = pattern.search(text)
+    return int(m.group(1)) if m else None
+
+
+def parse_float(pattern, text):
+    m = pattern.search(text)
+    return float(m.group(1)) if m else None
+
+
+def build_wrapper():
+    """Compile rss_wrap.c next to this script if it is missing or stale."""
+    here = os.path.dirname(os.path.abspath(__file__))
+    source = os.path.join(here, 'rss_wrap.c')
+    binary = os.path.join(here, 'rss_wrap')
+    if (not os.path.exists(binary)
+            or os.path.getmtime(binary) < os.path.getmtime(source)):
+        cc = os.environ.get('CC', 'cc')
+        subprocess.check_call([cc, '-O2', '-o', binary, source])
+    return binary
+
+
+def run_once(wrapper, argv, timeout):
+    """Run argv, returning (status, wall_ms, peak_rss_kb, stdout)."""
+    # The solver is started by rss_wrap, which reports the solver's peak
+    # RSS on a pipe; measured from here it would include our own memory.
+    rss_r, rss_w = os.pipe()
+    start = time.monotonic()
+    try:
+        proc = subprocess.Popen([wrapper, str(rss_w)] + argv,
+                                stdout=subprocess.PIPE,
+                                stderr=subprocess.DEVNULL,
+                                pass_fds=(rss_w,),
+                                start_new_session=True)
+    except OSError as e:
+        os.close(rss_r)
+        os.close(rss_w)
+        print('cannot run %s: %s' % (wrapper, e), file=sys.stderr)
+        return 'error', 0.0, None, ''
+    os.close(rss_w)
+
+    # Drain stdout on a thread and block in wait4 rather than Popen.wait,
+    # so that the clock stops as soon as the child is reaped. A timer
+    # kills the whole process group when the timeout expires.
+    chunks = []
+    reader = threading.Thread(target=lambda: chunks.append(proc.stdout.read()))
+    reader.start()
+    killed = threading.Event()
+
+    def kill():
+        try:
+            os.killpg(proc.pid, signal.SIGKILL)
+            killed.set()
+        except ProcessLookupError:
+            pass
+
+    timer = threading.Timer(timeout, kill)
+    timer.start()
+    _, status, _ = os.wait4(proc.pid, 0)
+    wall_ms = (time.monotonic() - start) * 1000.0
+    timer.cancel()
+    proc.returncode = os.waitstatus_to_exitcode(status)
+    # Descendants still holding stdout are in the same group.
+    reader.join(1.0)
+    if reader.is_alive():
+        kill()
+        reader.join()
+    proc.stdout.close()
+    with os.fdopen(rss_r) as f:
+        report = f.read().strip()
+    # ru_maxrss is reported in kilobytes on Linux.
+    rss = int(report) if report else None
+
+    if killed.is_set() and proc.returncode == -signal.SIGKILL:
+        state = 'timeout'
+    elif proc.returncode != 0:
+        state = 'error'
+    else:
+        state = 'ok'
+    return state, wall_ms, rss, b''.join(chunks).decode(errors='replace')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--root', required=True, help='ARG Database root directory')
+    parser.add_argument('--family', action='append', required=True,
+                        help='glob below ROOT selecting graph files (repeatable)')
+    parser.add_argument('--cmd', required=True, help='solver command template')
+    parser.add_argument('--variant', help='variant name recorded in the results '
+                        '(default: the solver executable name)')
+    parser.add_argument('--limit', type=int, default=0,
+                        help='max instances per family (0 = all)')
+    parser.add_argument('--repeat', type=int, default=1, help='runs per instance')
+    parser.add_argument('--timeout', type=float, default=60.0,
+                        help='per-run timeout in seconds')
+    parser.add_argument('--size-re', default=DEFAULT_SIZE_RE)
+    parser.add_argument('--nodes-re', default=DEFAULT_NODES_RE)
+    parser.add_argument('--time-re', default=DEFAULT_TIME_RE)
+    parser.add_argument('--csv', help='write results as CSV')
+    parser.add_argument('--json', help='write results as JSON')
+    args = parser.parse_args()
+
+    template = shlex.split(args.cmd)
+    if not template:
+        parser.error('empty --cmd')
+    if shutil.which(template[0]) is None:
+        parser.error('solver %s not found or not executable' % template[0])
+    variant = args.variant or os.path.basename(template[0])
+    size_re = re.compile(args.size_re)
+    nodes_re = re.compile(args.nodes_re)
+    time_re = re.compile(args.time_re)
+
+    wrapper = build_wrapper()
+    # A trivial command must report a trivial peak RSS, or the memory
+    # column would be measuring something other than the solver.
+    _, _, rss, _ = run_once(wrapper, ['/bin/true'], 5)
+    if rss is None or rss > RSS_SANITY_KB:
+        print('peak RSS of /bin/true measured as %s kB; memory accounting is '
+              'broken' % rss, file=sys.stderr)
+        return 1
+
+    instances = discover(args.root, args.family, args.limit)
+    if not instances:
+        print('no instances matched', file=sys.stderr)
+        return 1
+
+    rows = []
+    for family, name, graphs in instances:
+        argv = []
+        for word in template:
+            if word == '{graphs}':
+                argv.extend(graphs)
+            else:
+                argv.append(word.replace('{timeout}', str(math.ceil(args.timeout))))
+        for rep in range(args.repeat):
+            status, wall_ms, rss, out = run_once(wrapper, argv, args.timeout)
+            row = {
+                'variant': variant,
+                'family': family,
+                'instance': name,
+                'graphs': len(graphs),
+                'repeat': rep,
+                'status': status,
+                'wall_ms': round(wall_ms, 3),
+                'solver_ms': parse_float(time_re, out),
+                'nodes': parse_int(nodes_re, out),
+                'size': parse_int(size_re, out) if status == 'ok' else None,
+                'peak_rss_kb': rss,
+            }
+            if status == 'ok' and row['size'] is None:
+                row['status'] = status = 'noparse'
+            rows.append(row)
+            print('%-40s %d %-7s %10.1f ms  size=%s nodes=%s rss=%s kB'
+                  % (name, rep, status, wall_ms, row['size'], row['nodes'], rss))
+
+    if args.csv:
+        with open(args.csv, 'w', newline='') as f:
+            writer = csv.DictWriter(f, fieldnames=FIELDS)
+            writer.writeheader()
+            writer.writerows(rows)
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump({'variant': variant, 'command': args.cmd,
+                       'timeout': args.timeout, 'runs': rows}, f, indent=1)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,116 @@
+// Reading and writing graphs in the binary ARG Database format.
+//
+// A file is a sequence of little-endian 16-bit words:
+//   n
+//   label of vertex 0 .. n-1
+//   for each vertex: out-degree d, then d pairs (target, edge label)
+//
+// The McSplit-derived solvers keep only the top bits of each label (the
+// number of bits kept grows with n), so writers should store labels in
+// the high bits; see encode_label().
+
+#ifndef ARG_FORMAT_H
+#define ARG_FORMAT_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+struct ArgGraph {
+    int n;
+    std::vector<unsigned> label;
+    std::vector<std::vector<std::pair<int, unsigned>>> out;   // (target, edge label)
+
+    ArgGraph(int n = 0) : n(n), label(n, 0), out(n) {}
+};
+
+static inline void arg_fail(const char* msg, const char* filename)
+{
+    fprintf(stderr, "%s: %s\n", filename, msg);
+    exit(1);
+}
+
+static inline unsigned arg_read_word(FILE* f, const char* filename)
+{
+    unsigned char a[2];
+    if (fread(a, 1, 2, f) != 2)
+        arg_fail("unexpected end of file", filename);
+    return a[0] | (a[1] << 8);
+}
+
+static inline void arg_write_word(FILE* f, unsigned w)
+{
+    unsigned char a[2] = { (unsigned char) (w & 0xFF), (unsigned char) ((w >> 8) & 0xFF) };
+    fwrite(a, 1, 2, f);
+}
+
+// Number of label bits the McSplit readers keep for a graph with n vertices.
+static inline int arg_label_bits(int n)
+{
+    int m = n * 33 / 100;
+    int p = 1;
+    int k1 = 0;
+    int k2 = 0;
+    while (p < m && k1 < 16) {
+        p *= 2;
+        k1 = k2;
+        k2++;
+    }
+    return k1;
+}
+
+// Place label (drawn from an alphabet of the given size) in the high bits
+// of a 16-bit word, so that coarsening by a reader only merges labels.
+static inline unsigned encode_label(unsigned label, unsigned alphabet)
+{
+    int bits = 0;
+    while ((1u << bits) < alphabet)
+        bits++;
+    return bits == 0 ? 0 : label << (16 - bits);
+}
+
+static inline ArgGraph read_arg_graph(const char* filename)
+{
+    FILE* f = fopen(filename, "rb");
+    if (f == NULL)
+        arg_fail("cannot open file", filename);
+    ArgGraph g(arg_read_word(f, filename));
+    for (int i = 0; i < g.n; i++)
+        g.label[i] = arg_read_word(f, filename);
+    for (int i = 0; i < g.n; i++) {
+        int len = arg_read_word(f, filename);
+        for (int j = 0; j < len; j++) {
+            int target = arg_read_word(f, filename);
+            unsigned edge_label = arg_read_word(f, filename);
+            if (target >= g.n)
+                arg_fail("edge target out of range", filename);
+            g.out[i].push_back({target, edge_label});
+        }
+    }
+    fclose(f);
+    return g;
+}
+
+static inline void write_arg_graph(const char* filename, const ArgGraph& g)
+{
+    FILE* f = fopen(filename, "wb");
+    if (f == NULL)
+        arg_fail("cannot create file", filename);
+    if (g.n > 0xFFFF)
+        arg_fail("too many vertices for the ARG format", filename);
+    arg_write_word(f, g.n);
+    for (int i = 0; i < g.n; i++)
+        arg_write_word(f, g.label[i]);
+    for (int i = 0; i < g.n; i++) {
+        arg_write_word(f, g.out[i].size());
+        for (auto& e : g.out[i]) {
+            arg_write_word(f, e.first);
+            arg_write_word(f, e.second);
+        }
+    }
+    if (fclose(f) != 0)
+        arg_fail("write failed", filename);
+}
+
+#endif
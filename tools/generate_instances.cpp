@@ -0,0 +1,356 @@
+// Synthetic multigraph instances with a planted common subgraph.
+//
+// Writes K graphs in ARG format (STEM.A00, STEM.B00, ...) that all contain
+// the same labelled pattern of S vertices as an induced subgraph, at a
+// different random position and vertex numbering in each graph. The
+// maximum common induced subgraph of the set therefore has at least S
+// vertices; S is a lower bound, not the exact optimum, although a large
+// label alphabet makes larger accidental matches unlikely. For the connected
+// MCS the bound only holds if the pattern is connected, which mesh patterns
+// always are and random or bvg patterns are with --connected. The pattern's
+// vertex ids in each graph and whether it is connected are written to
+// STEM.planted.
+//
+// Build: g++ -O2 -std=c++11 -o generate_instances generate_instances.cpp
+
+#include "arg_format.h"
+
+#include <argp.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+enum GraphType { RANDOM, MESH, BVG };
+
+static char doc[] = "Generate a set of labelled graphs in ARG format with a planted common subgraph";
+static char args_doc[] = "STEM";
+static struct argp_option options[] = {
+    {"vertices", 'n', "N", 0, "Vertices per graph (default 100)"},
+    {"graphs", 'k', "K", 0, "Number of graphs (default 3)"},
+    {"planted", 's', "S", 0, "Vertices in the planted common subgraph (default N/4)"},
+    {"type", 't', "TYPE", 0, "random, mesh or bvg (default random)"},
+    {"density", 'd', "P", 0, "Edge probability for random graphs (default 0.1)"},
+    {"valence", 'v', "V", 0, "Maximum degree for bvg graphs (default 4)"},
+    {"labels", 'l', "L", 0, "Vertex label alphabet size (default 1)"},
+    {"edge-labels", 'e', "L", 0, "Edge label alphabet size (default 1)"},
+    {"connected", 'c', 0, 0, "Make the planted subgraph connected"},
+    {"seed", 'r', "SEED", 0, "Random seed (default 0)"},
+    { 0 }
+};
+
+static struct {
+    int n = 100;
+    int k = 3;
+    int s = -1;
+    GraphType type = RANDOM;
+    double density = 0.1;
+    int valence = 4;
+    unsigned labels = 1;
+    unsigned edge_labels = 1;
+    bool connected = false;
+    unsigned long seed = 0;
+    char* stem = NULL;
+} arguments;
+
+static error_t parse_opt (int key, char *arg, struct argp_state *state) {
+    switch (key) {
+        case 'n': arguments.n = std::stoi(arg); break;
+        case 'k': arguments.k = std::stoi(arg); break;
+        case 's': arguments.s = std::stoi(arg); break;
+        case 't':
+            if (!strcmp(arg, "random")) arguments.type = RANDOM;
+            else if (!strcmp(arg, "mesh")) arguments.type = MESH;
+            else if (!strcmp(arg, "bvg")) arguments.type = BVG;
+            else argp_error(state, "unknown graph type %s", arg);
+            break;
+        case 'd': arguments.density = std::stod(arg); break;
+        case 'v': arguments.valence = std::stoi(arg); break;
+        case 'l': arguments.labels = std::stoul(arg); break;
+        case 'e': arguments.edge_labels = std::stoul(arg); break;
+        case 'c': arguments.connected = true; break;
+        case 'r': arguments.seed = std::stoul(arg); break;
+        case ARGP_KEY_ARG:
+            if (state->arg_num >= 1) argp_usage(state);
+            arguments.stem = arg;
+            break;
+        case ARGP_KEY_END:
+            if (state->arg_num < 1) argp_usage(state);
+            break;
+        default: return ARGP_ERR_UNKNOWN;
+    }
+    return 0;
+}
+
+static struct argp argp = { options, parse_opt, args_doc, doc };
+
+struct Arc {
+    int from, to;
+    unsigned label;
+};
+
+// Graph over abstract vertex ids, before the per-graph renumbering.
+struct Shape {
+    int n;
+    vector<unsigned> label;
+    vector<Arc> arcs;
+    vector<int> degree;
+    std::set<std::pair<int, int>> edges;   // unordered pairs, for membership
+
+    Shape(int n) : n(n), label(n, 0), degree(n, 0) {}
+
+    bool adjacent(int a, int b) const {
+        return edges.count({std::min(a, b), std::max(a, b)}) != 0;
+    }
+
+    void add_arc(int from, int to, unsigned edge_label) {
+        arcs.push_back({from, to, edge_label});
+        edges.insert({std::min(from, to), std::max(from, to)});
+        degree[from]++;
+        degree[to]++;
+    }
+};
+
+static std::mt19937_64 rng;
+
+static unsigned random_label(unsigned alphabet)
+{
+    return encode_label(std::uniform_int_distribution<unsigned>(0, alphabet - 1)(rng), alphabet);
+}
+
+static int mesh_width(int n)
+{
+    int w = 1;
+    while ((w + 1) * (w + 1) <= n)
+        w++;
+    return w;
+}
+
+// Add an arc between a and b with random orientation and edge label.
+static void add_random_arc(Shape& g, int a, int b)
+{
+    if (std::uniform_int_distribution<int>(0, 1)(rng))
+        std::swap(a, b);
+    g.add_arc(a, b, random_label(arguments.edge_labels));
+}
+
+// Add edges of the requested type between pairs of vertices that are not
+// both fixed (fixed[v] true), leaving the fixed part untouched.
+static void fill_edges(Shape& g, const vector<bool>& fixed)
+{
+    switch (arguments.type) {
+    case RANDOM: {
+        std::bernoulli_distribution coin(arguments.density);
+        for (int a = 0; a < g.n; a++)
+            for (int b = a + 1; b < g.n; b++)
+                if (!(fixed[a] && fixed[b]) && !g.adjacent(a, b) && coin(rng))
+                    add_random_arc(g, a, b);
+        break;
+    }
+    case MESH: {
+        int w = mesh_width(g.n);
+        for (int a = 0; a < g.n; a++) {
+            if (a % w != w - 1 && a + 1 < g.n && !(fixed[a] && fixed[a + 1]))
+                g.add_arc(a, a + 1, random_label(arguments.edge_labels));
+            if (a + w < g.n && !(fixed[a] && fixed[a + w]))
+                g.add_arc(a, a + w, random_label(arguments.edge_labels));
+        }
+        break;
+    }
+    case BVG: {
+        vector<int> open;
+        for (int v = 0; v < g.n; v++)
+            if (g.degree[v] < arguments.valence)
+                open.push_back(v);
+        long attempts = (long) g.n * arguments.valence * 4;
+        while (open.size() >= 2 && attempts-- > 0) {
+            std::uniform_int_distribution<size_t> pick(0, open.size() - 1);
+            size_t i = pick(rng);
+            size_t j = pick(rng);
+            int a = open[i];
+            int b = open[j];
+            if (a == b || (fixed[a] && fixed[b]) || g.adjacent(a, b))
+                continue;
+            add_random_arc(g, a, b);
+            // Drop saturated vertices, higher index first so i stays valid.
+            if (i < j) std::swap(i, j);
+            if (g.degree[open[i]] >= arguments.valence) { open[i] = open.back(); open.pop_back(); }
+            if (g.degree[open[j]] >= arguments.valence) { open[j] = open.back(); open.pop_back(); }
+        }
+        break;
+    }
+    }
+}
+
+static Shape make_pattern(int s)
+{
+    Shape p(s);
+    for (int v = 0; v < s; v++)
+        p.label[v] = random_label(arguments.labels);
+    if (arguments.type == MESH) {
+        // s consecutive row-major cells of the mesh of the full graph width,
+        // so that it matches the mesh edges wherever it is placed.
+        int w = mesh_width(arguments.n);
+        for (int a = 0; a < s; a++) {
+            if (a % w != w - 1 && a + 1 < s)
+                p.add_arc(a, a + 1, random_label(arguments.edge_labels));
+            if (a + w < s)
+                p.add_arc(a, a + w, random_label(arguments.edge_labels));
+        }
+    } else {
+        if (arguments.connected) {
+            // Random spanning tree first: attach each vertex to an earlier
+            // one with room left, which the previous vertex always has when
+            // the valence is at least 2.
+            for (int v = 1; v < s; v++) {
+                vector<int> room;
+                for (int u = 0; u < v; u++)
+                    if (arguments.type != BVG || p.degree[u] < arguments.valence)
+                        room.push_back(u);
+                int u = room[std::uniform_int_distribution<size_t>(0, room.size() - 1)(rng)];
+                add_random_arc(p, u, v);
+            }
+        }
+        fill_edges(p, vector<bool>(s, false));
+    }
+    return p;
+}
+
+static bool is_connected(const Shape& g)
+{
+    if (g.n == 0)
+        return true;
+    vector<vector<int>> adj(g.n);
+    for (auto& a : g.arcs) {
+        adj[a.from].push_back(a.to);
+        adj[a.to].push_back(a.from);
+    }
+    vector<bool> seen(g.n, false);
+    vector<int> stack = {0};
+    seen[0] = true;
+    int count = 1;
+    while (!stack.empty()) {
+        int v = stack.back();
+        stack.pop_back();
+        for (int w : adj[v])
+            if (!seen[w]) {
+                seen[w] = true;
+                count++;
+                stack.push_back(w);
+            }
+    }
+    return count == g.n;
+}
+
+// Abstract vertex that pattern vertex j occupies in a fresh graph.
+static vector<int> choose_slots(int n, int s)
+{
+    vector<int> slots;
+    if (arguments.type == MESH) {
+        int w = mesh_width(n);
+        int last_row = (n - s) / w;
+        int row = std::uniform_int_distribution<int>(0, last_row)(rng);
+        for (int j = 0; j < s; j++)
+            slots.push_back(row * w + j);
+    } else {
+        vector<int> all(n);
+        for (int v = 0; v < n; v++)
+            all[v] = v;
+        std::shuffle(all.begin(), all.end(), rng);
+        slots.assign(all.begin(), all.begin() + s);
+    }
+    return slots;
+}
+
+static string graph_name(int i)
+{
+    string letters;
+    for (i++; i > 0; i = (i - 1) / 26)
+        letters.insert(letters.begin(), 'A' + (i - 1) % 26);
+    return string(arguments.stem) + "." + letters + "00";
+}
+
+int main(int argc, char** argv) {
+    argp_parse(&argp, argc, argv, 0, 0, 0);
+
+    int n = arguments.n;
+    int s = arguments.s < 0 ? n / 4 : arguments.s;
+    if (n < 1 || n > 0xFFFF) {
+        fprintf(stderr, "Vertex count must be between 1 and 65535\n");
+        return 1;
+    }
+    if (arguments.k < 1 || s > n) {
+        fprintf(stderr, "Need at least one graph and a planted size of at most N\n");
+        return 1;
+    }
+    if (arguments.labels < 1 || arguments.labels > 0x10000 ||
+            arguments.edge_labels < 1 || arguments.edge_labels > 0x10000) {
+        fprintf(stderr, "Label alphabets must have between 1 and 65536 symbols\n");
+        return 1;
+    }
+    if (!(arguments.density >= 0 && arguments.density <= 1)) {
+        fprintf(stderr, "Density must be between 0 and 1\n");
+        return 1;
+    }
+    if (arguments.connected && arguments.type == BVG && arguments.valence < std::min(s - 1, 2)) {
+        fprintf(stderr, "A connected planted subgraph needs a valence of at least 2\n");
+        return 1;
+    }
+    rng.seed(arguments.seed);
+
+    Shape pattern = make_pattern(s);
+    bool connected = is_connected(pattern);
+
+    string planted_name = string(arguments.stem) + ".planted";
+    FILE* planted = fopen(planted_name.c_str(), "w");
+    if (planted == NULL) {
+        fprintf(stderr, "Cannot create %s\n", planted_name.c_str());
+        return 1;
+    }
+    fprintf(planted, "planted %d\n", s);
+    fprintf(planted, "connected %s\n", connected ? "yes" : "no");
+
+    for (int i = 0; i < arguments.k; i++) {
+        vector<int> slots = choose_slots(n, s);
+        vector<bool> fixed(n, false);
+        Shape g(n);
+        for (int v = 0; v < n; v++)
+            g.label[v] = random_label(arguments.labels);
+        for (int j = 0; j < s; j++) {
+            fixed[slots[j]] = true;
+            g.label[slots[j]] = pattern.label[j];
+        }
+        for (auto& a : pattern.arcs)
+            g.add_arc(slots[a.from], slots[a.to], a.label);
+        fill_edges(g, fixed);
+
+        // Renumber so the pattern does not sit at the same ids everywhere.
+        vector<int> perm(n);
+        for (int v = 0; v < n; v++)
+            perm[v] = v;
+        std::shuffle(perm.begin(), perm.end(), rng);
+
+        ArgGraph out(n);
+        for (int v = 0; v < n; v++)
+            out.label[perm[v]] = g.label[v];
+        for (auto& a : g.arcs)
+            out.out[perm[a.from]].push_back({perm[a.to], a.label});
+        string name = graph_name(i);
+        write_arg_graph(name.c_str(), out);
+
+        fprintf(planted, "%s", name.c_str());
+        for (int j = 0; j < s; j++)
+            fprintf(planted, " %d", perm[slots[j]]);
+        fprintf(planted, "\n");
+        printf("%s: %d vertices, %zu edges\n", name.c_str(), n, g.arcs.size());
+    }
+    fclose(planted);
+    printf("Planted common subgraph: %d vertices, %zu edges, %s\n", s, pattern.arcs.size(),
+            connected ? "connected" : "not connected");
+}
@@ -0,0 +1,194 @@
+// Cheap upper bound on the MCS of a set of ARG graphs, computed before
+// running an exact multigraph solver.
+//
+// The bound is the label-class bound McSplit uses at the root: for every
+// vertex label, the smallest number of vertices carrying it in any graph.
+// As in McSplit's add_edge, a vertex with a self-loop gets the top label
+// bit set, so it can only match other looped vertices.
+// It is computed for every pair of graphs and for the whole set. In
+// connected mode a vertex can only take part in a common subgraph of two
+// or more vertices if it has a neighbour that can too, so vertices are
+// filtered to a fixpoint before counting.
+//
+// With --threshold K the exit status tells a caller whether running the
+// solver can pay off: 0 if the bound is at least K, 2 if it is not.
+// --raw-labels compares labels more finely than the McSplit readers do, so
+// its bound can fall below what those solvers find; do not use it to skip
+// McSplit runs.
+//
+// Build: g++ -O2 -std=c++11 -o prescreen prescreen.cpp
+
+#include "arg_format.h"
+
+#include <argp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <map>
+#include <string>
+#include <vector>
+
+using std::vector;
+
+static char doc[] = "Upper-bound the maximum common subgraph of a set of graphs";
+static char args_doc[] = "FILENAME1 FILENAME2 [FILENAME...]";
+static struct argp_option options[] = {
+    {"labelled", 'a', 0, 0, "Use vertex labels"},
+    {"connected", 'c', 0, 0, "Bound the maximum common connected subgraph"},
+    {"raw-labels", 'r', 0, 0, "Compare full 16-bit labels instead of the top bits kept by McSplit "
+            "(the bound is then not valid for McSplit solvers; do not combine with -t to skip them)"},
+    {"threshold", 't', "K", 0, "Exit with status 2 if the bound is below K"},
+    { 0 }
+};
+
+static struct {
+    bool labelled = false;
+    bool connected = false;
+    bool raw_labels = false;
+    int threshold = -1;
+    vector<char*> filenames;
+} arguments;
+
+static error_t parse_opt (int key, char *arg, struct argp_state *state) {
+    switch (key) {
+        case 'a': arguments.labelled = true; break;
+        case 'c': arguments.connected = true; break;
+        case 'r': arguments.raw_labels = true; break;
+        case 't': arguments.threshold = std::stoi(arg); break;
+        case ARGP_KEY_ARG: arguments.filenames.push_back(arg); break;
+        case ARGP_KEY_END:
+            if (arguments.filenames.size() < 2) argp_usage(state);
+            break;
+        default: return ARGP_ERR_UNKNOWN;
+    }
+    return 0;
+}
+
+static struct argp argp = { options, parse_opt, args_doc, doc };
+
+struct Screened {
+    vector<unsigned> label;
+    vector<vector<int>> adj;   // undirected, both directions
+};
+
+static Screened prepare(const ArgGraph& g)
+{
+    Screened s;
+    int k1 = arg_label_bits(g.n);
+    for (int v = 0; v < g.n; v++) {
+        unsigned l = 0;
+        if (arguments.labelled)
+            l = arguments.raw_labels ? g.label[v] : (k1 == 0 ? 0 : g.label[v] >> (16 - k1));
+        s.label.push_back(l);
+    }
+    s.adj.resize(g.n);
+    for (int v = 0; v < g.n; v++)
+        for (auto& e : g.out[v])
+            if (e.first != v) {
+                s.adj[v].push_back(e.first);
+                s.adj[e.first].push_back(v);
+            } else {
+                s.label[v] |= (1u << 31);
+            }
+    return s;
+}
+
+// Label-class bound over the given graphs.
+static int bound(const vector<const Screened*>& gs)
+{
+    vector<vector<bool>> alive;
+    for (auto g : gs)
+        alive.emplace_back(g->label.size(), true);
+
+    std::map<unsigned, int> common;
+    bool any_common = false;
+    for (bool changed = true; changed; ) {
+        changed = false;
+        // Smallest count of each label over the graphs; 0 if any lacks it.
+        common.clear();
+        for (size_t i = 0; i < gs.size(); i++) {
+            std::map<unsigned, int> count;
+            for (size_t v = 0; v < alive[i].size(); v++)
+                if (alive[i][v])
+                    count[gs[i]->label[v]]++;
+            if (i == 0) {
+                common = count;
+            } else {
+                for (auto& c : common) {
+                    auto it = count.find(c.first);
+                    c.second = it == count.end() ? 0 : std::min(c.second, it->second);
+                }
+            }
+        }
+        for (auto& c : common)
+            if (c.second > 0)
+                any_common = true;
+
+        for (size_t i = 0; i < gs.size(); i++) {
+            for (size_t v = 0; v < alive[i].size(); v++) {
+                if (!alive[i][v])
+                    continue;
+                bool keep = common[gs[i]->label[v]] > 0;
+                if (keep && arguments.connected) {
+                    keep = false;
+                    for (int w : gs[i]->adj[v])
+                        if (alive[i][w]) { keep = true; break; }
+                }
+                if (!keep) {
+                    alive[i][v] = false;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    int total = 0;
+    for (auto& c : common)
+        total += c.second;
+    // A single vertex is always connected.
+    if (arguments.connected && total == 0 && any_common)
+        total = 1;
+    return total;
+}
+
+int main(int argc, char** argv) {
+    argp_parse(&argp, argc, argv, 0, 0, 0);
+
+    auto start = std::chrono::steady_clock::now();
+
+    vector<Screened> graphs;
+    for (char* filename : arguments.filenames)
+        graphs.push_back(prepare(read_arg_graph(filename)));
+
+    int pair_bound = INT_MAX;
+    size_t pair_i = 0, pair_j = 1;
+    for (size_t i = 0; i < graphs.size(); i++)
+        for (size_t j = i + 1; j < graphs.size(); j++) {
+            int b = bound({&graphs[i], &graphs[j]});
+            if (b < pair_bound) {
+                pair_bound = b;
+                pair_i = i;
+                pair_j = j;
+            }
+        }
+
+    vector<const Screened*> all;
+    for (auto& g : graphs)
+        all.push_back(&g);
+    int set_bound = std::min(pair_bound, bound(all));
+
+    auto stop = std::chrono::steady_clock::now();
+    auto time_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count();
+
+    printf("Pairwise bound:  %d (%s, %s)\n", pair_bound,
+            arguments.filenames[pair_i], arguments.filenames[pair_j]);
+    printf("Upper bound:     %d\n", set_bound);
+    printf("Time (ms):       %.3f\n", time_elapsed / 1000.0);
+
+    if (arguments.threshold >= 0 && set_bound < arguments.threshold) {
+        printf("Below threshold %d: search skipped\n", arguments.threshold);
+        return 2;
+    }
+    return 0;
+}